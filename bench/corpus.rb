@@ -0,0 +1,190 @@
+require 'fileutils'
+require 'tmpdir'
+require 'protocol_buffers'
+
+module ProtocolBuffers
+  module Bench
+    # Builds the message corpus used by the benchmarks.
+    #
+    # Each <tt>.proto</tt> file is compiled with the protoc-gen-ruby plugin and
+    # the resulting classes are loaded. If protoc or the plugin is not
+    # available, the plugin rejects the file, or its output fails to load
+    # (it doesn't support groups, for instance), the pre-generated
+    # <tt>.pb.rb</tt> checked in next to the <tt>.proto</tt> is used instead.
+    #
+    # Messages are then synthesized from the field reflection data, so any
+    # schema can be benchmarked without hand-written fixtures.
+    class Corpus
+      PROTO_DIR = File.expand_path('../../spec/proto_files', __FILE__)
+      PLUGIN = File.expand_path('../../bin/protoc-gen-ruby', __FILE__)
+
+      # depth:  how many levels of nested messages to fill in
+      # width:  number of elements in repeated scalar fields
+      # fanout: number of elements in repeated message fields
+      # bytes:  length of string and bytes values
+      SIZES = {
+        'small'  => { :depth => 2, :width => 4,   :fanout => 2, :bytes => 16 },
+        'medium' => { :depth => 4, :width => 64,  :fanout => 3, :bytes => 1024 },
+        'large'  => { :depth => 5, :width => 1024, :fanout => 3, :bytes => 16384 },
+      }
+
+      attr_reader :size, :loaded_from
+
+      def self.plugin
+        ENV['PROTOC_GEN_RUBY'] || PLUGIN
+      end
+
+      def initialize(size = 'small', opts = {})
+        @size = size
+        @params = SIZES.fetch(size) { raise(ArgumentError, "Unknown corpus size: #{size}") }
+        @params = @params.merge(opts)
+        @random = Random.new(opts[:seed] || 1234)
+        @loaded_from = {}
+      end
+
+      # Load the given proto files, returning the top-level message classes
+      # they define.
+      def load_protos(names)
+        names.map { |name| load_proto(name) }.flatten
+      end
+
+      def load_proto(name)
+        before = message_classes
+
+        proto = File.join(PROTO_DIR, "#{name}.proto")
+        Dir.mktmpdir do |dir|
+          output = self.class.compile(proto, dir, PROTO_DIR)
+          if output && load_generated(output)
+            @loaded_from[name] = :plugin
+          else
+            load File.join(PROTO_DIR, "#{name}.pb.rb")
+            @loaded_from[name] = :pregenerated
+          end
+        end
+
+        (message_classes - before).select { |klass| top_level?(klass) }.sort_by(&:name)
+      end
+
+      # Run protoc with the ruby plugin. Returns the path of the generated
+      # file, or nil if the compile failed.
+      #
+      # The plugin is registered as protoc-gen-rbpb, since protoc 3 handles
+      # --ruby_out with its own built-in generator.
+      def self.compile(proto, out_dir, include_dir = File.dirname(proto))
+        return nil unless File.executable?(plugin)
+        output = File.join(out_dir, File.basename(proto, '.proto') + '.pb.rb')
+        ok = system('protoc', "--plugin=protoc-gen-rbpb=#{plugin}", "-I#{include_dir}",
+                    "--rbpb_out=#{out_dir}", proto, :err => File::NULL)
+        ok && File.exist?(output) ? output : nil
+      rescue Errno::ENOENT
+        nil
+      end
+
+      # Build a fully populated instance of +klass+. Every field is set, so
+      # required fields are satisfied at any depth.
+      def synthesize(klass, depth = @params[:depth])
+        message = klass.new
+        klass.fields.each do |tag, field|
+          if field.is_a?(Field::AggregateField)
+            next if depth <= 0 && field.otype != :required
+            if field.repeated?
+              @params[:fanout].times { message.__send__(field.name) << synthesize(field.proxy_class, depth - 1) }
+            else
+              message.__send__("#{field.name}=", synthesize(field.proxy_class, depth - 1))
+            end
+          elsif field.repeated?
+            message.__send__("#{field.name}=", Array.new(@params[:width]) { value_for(field) })
+          else
+            message.__send__("#{field.name}=", value_for(field))
+          end
+        end
+        message
+      end
+
+      # Generate the source of a large schema for codegen benchmarks:
+      # +messages+ messages of +fields+ fields each, every message referring to
+      # the one before it.
+      def self.big_schema(messages = 200, fields = 50)
+        types = %w(double float int32 int64 uint32 uint64 sint32 sint64 fixed32
+                   fixed64 sfixed32 sfixed64 bool string bytes)
+        labels = %w(optional repeated required)
+
+        src = "syntax = \"proto2\";\npackage bench_big;\n\n"
+        src << "enum Kind {\n"
+        8.times { |i| src << "  KIND_#{i} = #{i};\n" }
+        src << "}\n\n"
+        messages.times do |m|
+          src << "message Message#{m} {\n"
+          src << "  enum Nested { NESTED_A = 0; NESTED_B = 1; }\n"
+          fields.times do |f|
+            type = case f % 10
+              when 8 then m > 0 ? "Message#{m - 1}" : 'string'
+              when 9 then f.even? ? 'Kind' : 'Nested'
+              else types[f % types.size]
+              end
+            src << "  #{labels[f % labels.size]} #{type} field_#{f} = #{f + 1};\n"
+          end
+          src << "}\n\n"
+        end
+        src
+      end
+
+      private
+
+      # Load plugin output, undoing any constants it defined if it fails
+      # part way through.
+      def load_generated(path)
+        before = Object.constants
+        load path
+        true
+      rescue ScriptError, NameError => e
+        $stderr.puts "#{File.basename(path)} failed to load (#{e.class}), using the pre-generated file"
+        (Object.constants - before).each { |c| Object.send(:remove_const, c) }
+        false
+      end
+
+      def value_for(field)
+        case field
+        when Field::EnumField
+          field.valid_values[@random.rand(field.valid_values.size)]
+        when Field::BoolField
+          @random.rand(2) == 1
+        when Field::FloatField, Field::DoubleField
+          @random.rand * 1000.0
+        when Field::NumericField
+          # keep the values spread across the varint lengths
+          max = [field.max, 2**62].min
+          min = [field.min, -2**62].max
+          @random.rand(min..max) >> @random.rand(63)
+        when Field::StringField
+          Array.new(@params[:bytes]) { (97 + @random.rand(26)).chr }.join
+        when Field::BytesField
+          @random.bytes(@params[:bytes])
+        else
+          raise(ArgumentError, "Don't know how to synthesize #{field.class.name}")
+        end
+      end
+
+      # Classes still reachable through their constant; this skips any left
+      # behind by a failed load.
+      def message_classes
+        ObjectSpace.each_object(Class).select do |klass|
+          klass < ProtocolBuffers::Message && klass.name && resolve(klass.name).equal?(klass)
+        end
+      end
+
+      def top_level?(klass)
+        parent = klass.name.split('::')[0..-2]
+        parent.empty? || !(resolve(parent.join('::')) < ProtocolBuffers::Message)
+      end
+
+      # Object.const_get only takes nested names from Ruby 2.0
+      def resolve(name)
+        name.split('::').inject(Object) do |scope, c|
+          return nil unless scope.const_defined?(c, false)
+          scope.const_get(c, false)
+        end
+      end
+    end
+  end
+end
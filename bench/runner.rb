@@ -0,0 +1,212 @@
+require 'json'
+require 'time'
+require 'tmpdir'
+
+module ProtocolBuffers
+  module Bench
+    # Runs the benchmark cases and collects the results.
+    #
+    # Each case reports:
+    # ns_per_op::          wall-clock nanoseconds per operation
+    # payload_bytes::      size of the payload handled per operation (wire
+    #                      bytes for encode/decode, text for the text format,
+    #                      generated source for codegen). This is not the
+    #                      number of bytes allocated.
+    # allocations_per_op:: Ruby objects allocated per operation (nil for
+    #                      codegen, which runs out of process, and on Rubies
+    #                      without an allocation counter)
+    #
+    # Cases that could not be run are recorded with a +skipped+ reason
+    # instead of measurements.
+    class Runner
+      PROTOS = %w(simple featureful packed enums)
+
+      # GC.stat(:total_allocated_objects) needs MRI 2.2 or later
+      COUNTS_ALLOCATIONS = GC.respond_to?(:stat) && GC.stat.is_a?(Hash) &&
+        GC.stat.key?(:total_allocated_objects)
+
+      attr_reader :results
+
+      def initialize(opts = {})
+        @size = opts[:size] || 'small'
+        @min_time = opts[:min_time] || 0.5
+        @filter = opts[:filter] && Regexp.new(opts[:filter])
+        @results = []
+        @sources = {}
+      end
+
+      def run
+        # loaded here so that compare doesn't need the library on the load path
+        require File.expand_path('../corpus', __FILE__)
+
+        corpus = Corpus.new(@size)
+        classes = corpus.load_protos(PROTOS)
+        @sources = corpus.loaded_from.inject({}) { |h, (name, source)| h[name] = source.to_s; h }
+        @sources.each { |name, source| $stderr.puts "#{name}.proto: #{source}" }
+
+        classes.each do |klass|
+          message = corpus.synthesize(klass)
+          bench_message(klass, message)
+        end
+        bench_codegen
+        self
+      end
+
+      def bench_message(klass, message)
+        wire = message.serialize_to_string
+        text = message.text_format_to_string
+
+        measure('encode', klass.name, wire.bytesize) { message.serialize_to_string }
+        measure('decode', klass.name, wire.bytesize) { klass.parse(wire) }
+        measure('to_hash', klass.name, wire.bytesize) { message.to_hash }
+        measure('text_format', klass.name, text.bytesize) { message.text_format_to_string }
+        measure('text_parse', klass.name, text.bytesize) { klass.parse_from_text(text) }
+
+        # the methods protoc-gen-ruby specializes per message class
+        other = klass.parse(wire)
+        measure('==', klass.name, wire.bytesize) { message == other }
+        measure('hash', klass.name, wire.bytesize) { message.hash }
+        measure('dup', klass.name, wire.bytesize) { message.dup }
+        measure('valid?', klass.name, wire.bytesize) { message.valid? }
+      end
+
+      def bench_codegen
+        return unless selected?('codegen', 'bench_big')
+
+        Dir.mktmpdir do |dir|
+          proto = File.join(dir, 'bench_big.proto')
+          File.open(proto, 'w') { |f| f.write(Corpus.big_schema) }
+
+          output = Corpus.compile(proto, dir)
+          unless output
+            skip('codegen', 'bench_big', "#{Corpus.plugin} is not runnable or produced no output")
+            return
+          end
+          bytes = File.size(output)
+
+          measure('codegen', 'bench_big', bytes, false) { Corpus.compile(proto, dir) }
+        end
+      end
+
+      # Run the block repeatedly for at least +min_time+ seconds, doubling
+      # the batch size each round.
+      def measure(op, subject, bytes, count_allocations = true)
+        return unless selected?(op, subject)
+
+        yield # warm up
+
+        count_allocations &&= COUNTS_ALLOCATIONS
+        iterations = 0
+        batch = 1
+        allocations = 0
+        elapsed = 0
+        while elapsed < @min_time * 1_000_000_000
+          allocated_before = GC.stat(:total_allocated_objects) if count_allocations
+          start = now
+          batch.times { yield }
+          elapsed += now - start
+          allocations += GC.stat(:total_allocated_objects) - allocated_before if count_allocations
+          iterations += batch
+          batch *= 2
+        end
+
+        result = {
+          'op' => op,
+          'subject' => subject,
+          'iterations' => iterations,
+          'ns_per_op' => elapsed / iterations,
+          'payload_bytes' => bytes,
+          'allocations_per_op' => count_allocations ? allocations / iterations : nil,
+        }
+        @results << result
+        $stderr.puts format('%-12s %-40s %12d ns/op %10d payload bytes %10s allocs/op',
+                            op, subject, result['ns_per_op'], bytes, result['allocations_per_op'] || '-')
+        result
+      end
+
+      # Record a case that could not be run, so its absence shows up in the
+      # result file.
+      def skip(op, subject, reason)
+        result = { 'op' => op, 'subject' => subject, 'skipped' => reason }
+        @results << result
+        $stderr.puts format('%-12s %-40s skipped: %s', op, subject, reason)
+        result
+      end
+
+      def to_json(*args)
+        {
+          'commit' => commit,
+          'ruby' => "#{RUBY_ENGINE} #{RUBY_VERSION}",
+          'platform' => RUBY_PLATFORM,
+          'size' => @size,
+          'sources' => @sources,
+          'time' => Time.now.utc.iso8601,
+          'results' => @results,
+        }.to_json(*args)
+      end
+
+      def write(path)
+        FileUtils.mkdir_p(File.dirname(path))
+        File.open(path, 'w') { |f| f.write(JSON.pretty_generate(JSON.parse(to_json))) }
+        path
+      end
+
+      def commit
+        sha = `git rev-parse --short HEAD 2>#{File::NULL}`.strip
+        sha.empty? ? 'unknown' : sha
+      end
+
+      # Print the per-case change between two result files.
+      def self.compare(base_path, head_path, io = $stdout)
+        base = JSON.parse(File.read(base_path))
+        head = JSON.parse(File.read(head_path))
+        base_results = base['results'].inject({}) { |h, r| h[[r['op'], r['subject']]] = r; h }
+
+        # the corpus classes come either from the plugin or from the checked-in
+        # .pb.rb files, so two runs may not have measured the same code
+        base_sources = base['sources'] || {}
+        head_sources = head['sources'] || {}
+        (base_sources.keys | head_sources.keys).sort.each do |name|
+          b, h = base_sources[name] || '-', head_sources[name] || '-'
+          io.puts "#{name}.proto: #{b} -> #{h}"
+          io.puts "warning: #{name}.proto was loaded from #{b} in #{base['commit']} but from #{h} in #{head['commit']}" if b != h
+        end
+
+        io.puts format('%-12s %-40s %14s %14s %8s %10s %14s', 'op', 'subject',
+                       "#{base['commit']} ns", "#{head['commit']} ns", 'delta', 'allocs', 'payload_bytes')
+        head['results'].each do |r|
+          b = base_results[[r['op'], r['subject']]]
+          next unless b
+          if r['skipped'] || b['skipped']
+            io.puts format('%-12s %-40s skipped: %s', r['op'], r['subject'], r['skipped'] || b['skipped'])
+            next
+          end
+          delta = (r['ns_per_op'] - b['ns_per_op']) * 100.0 / b['ns_per_op']
+          allocs = r['allocations_per_op'] && b['allocations_per_op'] ?
+            format('%+d', r['allocations_per_op'] - b['allocations_per_op']) : '-'
+          payload = b['payload_bytes'] == r['payload_bytes'] ? r['payload_bytes'].to_s :
+            "#{b['payload_bytes']} -> #{r['payload_bytes']}"
+          io.puts format('%-12s %-40s %14d %14d %+7.1f%% %10s %14s', r['op'], r['subject'],
+                         b['ns_per_op'], r['ns_per_op'], delta, allocs, payload)
+        end
+      end
+
+      private
+
+      # Process.clock_gettime needs Ruby 2.1 or later
+      if Process.respond_to?(:clock_gettime)
+        def now
+          Process.clock_gettime(Process::CLOCK_MONOTONIC, :nanosecond)
+        end
+      else
+        def now
+          (Time.now.to_r * 1_000_000_000).to_i
+        end
+      end
+
+      def selected?(op, subject)
+        @filter.nil? || @filter =~ "#{op} #{subject}"
+      end
+    end
+  end
+end
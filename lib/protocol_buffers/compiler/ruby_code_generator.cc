@@ -53,9 +53,11 @@ bool RubyCodeGenerator::PrintPackage(
     // Build output filename.
     std::string output_file_name = SourceFilename2CompiledFilename(file->name());
 
-    // Get rid of directory
+    // Get rid of directory (if there is one)
     std::size_t loc = output_file_name.rfind("/");
-    output_file_name.erase(0, loc);
+    if (loc != std::string::npos) {
+        output_file_name.erase(0, loc + 1);
+    }
 
     pb::internal::scoped_ptr<pb::io::ZeroCopyOutputStream> output(output_directory->Open(output_file_name));
     pb::io::Printer printer(output.get(), '$');
@@ -239,6 +241,12 @@ bool RubyCodeGenerator::PrintMessage(
             result = result && PrintField(context, *descriptor.field(i));
         }
 
+        // Print specialized versions of the reflection-based Message methods
+        result = result && PrintEquality(context, descriptor);
+        result = result && PrintHash(context, descriptor);
+        result = result && PrintDup(context, descriptor);
+        result = result && PrintValidation(context, descriptor);
+
     context.printer.Outdent(); context.printer.Outdent();
     context.printer.Print("end\n");
 
@@ -286,6 +294,254 @@ bool RubyCodeGenerator::PrintField(
     return true;
 };
 
+bool RubyCodeGenerator::PrintEquality(
+    Context context,
+    const pb::Descriptor& descriptor
+) const {
+
+    // A field named `class` replaces the method the comparison relies on, and a private reader can't be called on
+    // `obj`, so fall back to Message#==
+    if (HasFieldNamed(descriptor, "class") || HasPrivateFieldName(descriptor)) {
+        return true;
+    }
+
+    context.printer.Print("\n");
+    context.printer.Print("def ==(obj)\n");
+    context.printer.Indent(); context.printer.Indent();
+        context.printer.Print("return false unless obj.is_a?(self.class)\n");
+
+        for (int i = 0; i < descriptor.field_count(); ++i) {
+            const pb::FieldDescriptor& field = *descriptor.field(i);
+
+            // Repeated fields are always set, so only their contents need comparing
+            if (field.is_repeated()) {
+                context.printer.Print("return false unless self.$name$ == obj.$name$\n", "name", field.name());
+
+            } else {
+                context.printer.Print("return false unless has_$name$? ? (obj.has_$name$? && self.$name$ == obj.$name$) : !obj.has_$name$?\n", "name", field.name());
+            }
+        }
+
+        context.printer.Print("true\n");
+    context.printer.Outdent(); context.printer.Outdent();
+    context.printer.Print("end\n");
+
+    return true;
+}
+
+bool RubyCodeGenerator::PrintHash(
+    Context context,
+    const pb::Descriptor& descriptor
+) const {
+
+    // Don't replace the reader of a field named `hash`, or call a private reader; Message#hash is used instead
+    if (HasFieldNamed(descriptor, "hash") || HasPrivateFieldName(descriptor)) {
+        return true;
+    }
+
+    context.printer.Print("\n");
+    context.printer.Print("def hash\n");
+    context.printer.Indent(); context.printer.Indent();
+        context.printer.Print("hash_code = 0\n");
+
+        // XOR the set fields together, so the result matches Message#hash
+        for (int i = 0; i < descriptor.field_count(); ++i) {
+            const pb::FieldDescriptor& field = *descriptor.field(i);
+
+            if (field.is_repeated()) {
+                context.printer.Print("hash_code ^= self.$name$.hash\n", "name", field.name());
+
+            } else {
+                context.printer.Print("hash_code ^= self.$name$.hash if has_$name$?\n", "name", field.name());
+            }
+        }
+
+        context.printer.Print("hash_code\n");
+    context.printer.Outdent(); context.printer.Outdent();
+    context.printer.Print("end\n");
+
+    return true;
+}
+
+bool RubyCodeGenerator::PrintDup(
+    Context context,
+    const pb::Descriptor& descriptor
+) const {
+
+    // Don't replace the reader of a field named `dup`, or rely on an initialize_* hook that a field reader has
+    // replaced; Message#dup is used instead
+    if (HasFieldNamed(descriptor, "dup") || HasPrivateFieldName(descriptor)) {
+        return true;
+    }
+
+    // Use the native instance-variable copy rather than Message#dup, which goes through the field setters
+    context.printer.Print("\n");
+    context.printer.Print("define_method(:dup, ::Kernel.instance_method(:dup))\n");
+
+    // Scalar fields are shared with the source, so only repeated and message fields need any further copying
+    bool has_aggregate_fields = false;
+    for (int i = 0; i < descriptor.field_count(); ++i) {
+        const pb::FieldDescriptor& field = *descriptor.field(i);
+
+        if (field.is_repeated() || field.cpp_type() == pb::FieldDescriptor::CPPTYPE_MESSAGE) {
+            has_aggregate_fields = true;
+        }
+    }
+
+    if (!has_aggregate_fields) {
+        return true;
+    }
+
+    context.printer.Print("\n");
+    context.printer.Print("def initialize_copy(source)\n");
+    context.printer.Indent(); context.printer.Indent();
+        context.printer.Print("super\n");
+
+        // Give the copy its own repeated fields and nested messages
+        for (int i = 0; i < descriptor.field_count(); ++i) {
+            const pb::FieldDescriptor& field = *descriptor.field(i);
+
+            std::map<std::string, std::string> formatter_args = {
+                {"name", field.name()},
+                {"number", std::to_string(field.number())}
+            };
+
+            if (field.is_repeated() && field.cpp_type() == pb::FieldDescriptor::CPPTYPE_MESSAGE) {
+                context.printer.Print(formatter_args, "@$name$ = @$name$.dup.collect! { |value| value.dup } if @$name$\n");
+
+            } else if (field.is_repeated()) {
+                context.printer.Print(formatter_args, "@$name$ = @$name$.dup if @$name$\n");
+
+            } else if (field.cpp_type() == pb::FieldDescriptor::CPPTYPE_MESSAGE) {
+                // An unset message field holds a default instance wired to notify the source message, so drop it
+                // and let the reader create a fresh one on first access
+                context.printer.Print(formatter_args, "if @set_fields[$number$]\n");
+                context.printer.Indent(); context.printer.Indent();
+                    context.printer.Print(formatter_args, "@$name$ = @$name$.dup\n");
+                context.printer.Outdent(); context.printer.Outdent();
+                context.printer.Print("else\n");
+                context.printer.Indent(); context.printer.Indent();
+                    context.printer.Print(formatter_args, "@set_fields[$number$] = nil\n");
+                context.printer.Outdent(); context.printer.Outdent();
+                context.printer.Print("end\n");
+            }
+        }
+
+    context.printer.Outdent(); context.printer.Outdent();
+    context.printer.Print("end\n");
+
+    return true;
+}
+
+bool RubyCodeGenerator::PrintValidation(
+    Context context,
+    const pb::Descriptor& descriptor
+) const {
+
+    // Without required fields anywhere below this message, the inherited check is already trivially true
+    std::set<const pb::Descriptor*> visited;
+    if (!HasRequiredFields(descriptor, visited)) {
+        return true;
+    }
+
+    // Like Message.valid?, only required fields are checked, and only required aggregate fields are recursed into.
+    // Message.valid? doesn't recurse into groups, so an invalid required group just falls through to super.
+    std::vector<std::string> checks;
+    for (int i = 0; i < descriptor.field_count(); ++i) {
+        const pb::FieldDescriptor& field = *descriptor.field(i);
+
+        if (!field.is_required()) {
+            continue;
+        }
+
+        checks.push_back("message.has_" + field.name() + "?");
+
+        if (field.cpp_type() == pb::FieldDescriptor::CPPTYPE_MESSAGE) {
+            std::set<const pb::Descriptor*> field_visited;
+            if (HasRequiredFields(*field.message_type(), field_visited)) {
+                checks.push_back("message." + field.name() + ".valid?");
+            }
+        }
+    }
+
+    context.printer.Print("\n");
+    context.printer.Print("def self.valid?(message, raise_exception = false)\n");
+    context.printer.Indent(); context.printer.Indent();
+
+        if (checks.empty()) {
+            context.printer.Print("true\n");
+
+        } else {
+            std::string condition = checks[0];
+            for (std::size_t i = 1; i < checks.size(); ++i) {
+                condition += " && " + checks[i];
+            }
+
+            // Fall back to the generic check to report (or raise for) the offending field
+            context.printer.Print("return true if $condition$\n", "condition", condition);
+            context.printer.Print("super\n");
+        }
+
+    context.printer.Outdent(); context.printer.Outdent();
+    context.printer.Print("end\n");
+
+    return true;
+}
+
+bool RubyCodeGenerator::HasRequiredFields(
+    const pb::Descriptor& descriptor,
+    std::set<const pb::Descriptor*>& visited
+) const {
+
+    // Guard against recursive message definitions
+    if (!visited.insert(&descriptor).second) {
+        return false;
+    }
+
+    for (int i = 0; i < descriptor.field_count(); ++i) {
+        const pb::FieldDescriptor& field = *descriptor.field(i);
+
+        if (field.is_required()) {
+            return true;
+        }
+
+        if (field.cpp_type() == pb::FieldDescriptor::CPPTYPE_MESSAGE && HasRequiredFields(*field.message_type(), visited)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RubyCodeGenerator::HasFieldNamed(
+    const pb::Descriptor& descriptor,
+    const std::string& name
+) const {
+
+    for (int i = 0; i < descriptor.field_count(); ++i) {
+        if (descriptor.field(i)->name() == name) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RubyCodeGenerator::HasPrivateFieldName(const pb::Descriptor& descriptor) const {
+    // Ruby makes methods with these names private, whichever class defines them
+    static const char* const private_names[] = {
+        "initialize_copy", "initialize_dup", "initialize_clone", "respond_to_missing?"
+    };
+
+    for (const char* name : private_names) {
+        if (HasFieldNamed(descriptor, name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 const std::string RubyCodeGenerator::GetRubyType(
     const pb::FieldDescriptor& descriptor
 ) const {
@@ -1,6 +1,7 @@
 #ifndef RUBY_CODE_GENERATOR_H_
 #define RUBY_CODE_GENERATOR_H_
 
+#include <set>
 #include <string>
 #include <regex>
 #include <google/protobuf/compiler/code_generator.h>
@@ -73,6 +74,38 @@ class RubyCodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
             const google::protobuf::FieldDescriptor& descriptor
         ) const;
 
+        bool PrintEquality(
+            Context context,
+            const google::protobuf::Descriptor& descriptor
+        ) const;
+
+        bool PrintHash(
+            Context context,
+            const google::protobuf::Descriptor& descriptor
+        ) const;
+
+        bool PrintDup(
+            Context context,
+            const google::protobuf::Descriptor& descriptor
+        ) const;
+
+        bool PrintValidation(
+            Context context,
+            const google::protobuf::Descriptor& descriptor
+        ) const;
+
+        bool HasRequiredFields(
+            const google::protobuf::Descriptor& descriptor,
+            std::set<const google::protobuf::Descriptor*>& visited
+        ) const;
+
+        bool HasFieldNamed(
+            const google::protobuf::Descriptor& descriptor,
+            const std::string& name
+        ) const;
+
+        bool HasPrivateFieldName(const google::protobuf::Descriptor& descriptor) const;
+
         const std::string GetRubyType(const google::protobuf::FieldDescriptor& descriptor) const;
 
         bool PrintService(
@@ -395,7 +395,9 @@ module ProtocolBuffers
       fields.each { |tag, field| self.__send__("#{field.name}=", nil) }
     end
 
-    # This is a shallow copy.
+    # This generic version is a shallow copy. Classes generated by
+    # protoc-gen-ruby override it with a copy that also duplicates their
+    # repeated fields and nested messages.
     def dup
       ret = self.class.new
       fields.each do |tag, field|
@@ -405,6 +407,16 @@ module ProtocolBuffers
       return ret
     end
 
+    # Called on the copy made by clone (and by the native dup that generated
+    # classes use). The copy gets its own set-field tracking and unknown
+    # fields, and is detached from the source's parent message.
+    def initialize_copy(source)
+      super
+      @set_fields = @set_fields.dup
+      @unknown_fields = @unknown_fields.dup if @unknown_fields
+      @parent_for_notify = @tag_for_notify = nil
+    end
+
     # Returns a hash of { tag => ProtocolBuffers::Field }
     def self.fields
       @fields || @fields = {}
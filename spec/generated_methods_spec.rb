@@ -0,0 +1,115 @@
+require File.expand_path(File.dirname(__FILE__) + '/spec_helper')
+
+$LOAD_PATH.unshift(File.join(File.dirname(__FILE__), "..", "lib"))
+require 'protocol_buffers'
+
+# generated_methods.pb.rb is the output of bin/protoc-gen-ruby for
+# generated_methods.proto, and must be regenerated when the plugin changes.
+describe ProtocolBuffers, "generated methods" do
+  before(:each) do
+    Object.send(:remove_const, :GeneratedMethods) if Object.const_defined?(:GeneratedMethods)
+    load File.join(File.dirname(__FILE__), "proto_files", "generated_methods.pb.rb")
+  end
+
+  def generic(method, message, *args)
+    ProtocolBuffers::Message.instance_method(method).bind(message).call(*args)
+  end
+
+  def holder
+    GeneratedMethods::Holder.new(
+      :numbers => [1, 2, 3],
+      :leaves => [GeneratedMethods::Leaf.new(:s => "one"), GeneratedMethods::Leaf.new],
+      :leaf => GeneratedMethods::Leaf.new(:s => "leaf"),
+      :id => 7,
+      :req => GeneratedMethods::Req.new(:r => 1),
+      :kind => GeneratedMethods::Kind::SECOND
+    )
+  end
+
+  it "agrees with the generic == and hash" do
+    a = holder
+    b = GeneratedMethods::Holder.parse(a.serialize_to_string)
+
+    (a == b).should == true
+    generic(:==, a, b).should == true
+    a.hash.should == generic(:hash, a)
+    a.hash.should == b.hash
+
+    b.leaves[1].s = "two"
+    (a == b).should == false
+    generic(:==, a, b).should == false
+
+    b = holder
+    b.leaf = nil
+    (a == b).should == false
+    generic(:==, a, b).should == false
+    b.hash.should == generic(:hash, b)
+  end
+
+  it "deep-copies repeated and nested fields on dup" do
+    a = holder
+    b = a.dup
+
+    b.should == a
+    b.numbers << 4
+    b.leaves[0].s = "changed"
+    b.leaves << GeneratedMethods::Leaf.new
+    b.leaf.s = "changed"
+    b.req.r = 2
+
+    a.numbers.should == [1, 2, 3]
+    a.leaves.size.should == 2
+    a.leaves[0].s.should == "one"
+    a.leaf.s.should == "leaf"
+    a.req.r.should == 1
+  end
+
+  it "notifies the copy, not the source, when an unset nested default is changed" do
+    a = GeneratedMethods::NoRequired.new
+    a.leaf.s.should == ""
+    b = a.dup
+
+    b.leaf.s = "set"
+    b.has_leaf?.should == true
+    a.has_leaf?.should == false
+  end
+
+  it "raises EncodeError from validate! when a nested required field is missing" do
+    a = GeneratedMethods::Holder.new(:id => 1, :req => GeneratedMethods::Req.new)
+
+    a.valid?.should == false
+    proc { a.validate! }.should raise_error(ProtocolBuffers::EncodeError)
+
+    a.req.r = 1
+    a.valid?.should == true
+  end
+
+  it "only generates valid? for messages with required fields in their subtree" do
+    GeneratedMethods::Holder.singleton_methods(false).should include(:valid?)
+    GeneratedMethods::NoRequired.singleton_methods(false).should_not include(:valid?)
+    GeneratedMethods::NoRequired.new.valid?.should == true
+  end
+
+  it "keeps the readers of fields named hash and dup" do
+    h = GeneratedMethods::HashField.new(:hash => "digest", :other => 1)
+    h.value_for_tag(1).should == "digest"
+    parsed = GeneratedMethods::HashField.parse(h.serialize_to_string)
+    parsed.hash.should == "digest"
+    parsed.should == h
+
+    d = GeneratedMethods::DupField.new(:dup => "copy", :leaves => [GeneratedMethods::Leaf.new(:s => "x")])
+    d.value_for_tag(1).should == "copy"
+    parsed = GeneratedMethods::DupField.parse(d.serialize_to_string)
+    parsed.dup.should == "copy"
+    parsed.should == d
+  end
+
+  it "falls back to the generic methods for fields with names Ruby makes private" do
+    a = GeneratedMethods::PrivateField.new(:initialize_copy => "x", :other => 1)
+    b = GeneratedMethods::PrivateField.parse(a.serialize_to_string)
+
+    (a == b).should == true
+    a.hash.should == b.hash
+    a.dup.should == a
+  end
+end
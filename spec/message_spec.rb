@@ -138,4 +138,17 @@ describe ProtocolBuffers, "message" do
     proc { f.get!(:i2) }.should raise_error(ArgumentError)
     proc { f.get!(:sub2) }.should raise_error(ArgumentError)
   end
+
+  it "gives a clone its own set fields and detaches it from its parent" do
+    c = Featureful::C.new
+    d = c.d.clone
+
+    d.f2.s = "cloned"
+    c.has_d?.should == false
+    d.has_f2?.should == true
+
+    d2 = d.clone
+    d2.f2 = nil
+    d.has_f2?.should == true
+  end
 end
@@ -0,0 +1,206 @@
+# Generated by the protocol buffer compiler. DO NOT EDIT!
+
+require 'protocol_buffers'
+
+
+module GeneratedMethods
+    module Kind
+        include ::ProtocolBuffers::Enum
+
+        set_fully_qualified_name "generated_methods.Kind"
+
+        FIRST = 1
+        SECOND = 2
+    end
+
+    # forward declarations
+    class Leaf < ::ProtocolBuffers::Message; end
+    class Req < ::ProtocolBuffers::Message; end
+    class Holder < ::ProtocolBuffers::Message; end
+    class NoRequired < ::ProtocolBuffers::Message; end
+    class HashField < ::ProtocolBuffers::Message; end
+    class DupField < ::ProtocolBuffers::Message; end
+    class PrivateField < ::ProtocolBuffers::Message; end
+
+    class Leaf < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.Leaf"
+
+        optional :string, :s, 1
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless has_s? ? (obj.has_s? && self.s == obj.s) : !obj.has_s?
+            true
+        end
+
+        def hash
+            hash_code = 0
+            hash_code ^= self.s.hash if has_s?
+            hash_code
+        end
+
+        define_method(:dup, ::Kernel.instance_method(:dup))
+    end
+
+    class Req < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.Req"
+
+        required :int32, :r, 1
+        optional :string, :s, 2
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless has_r? ? (obj.has_r? && self.r == obj.r) : !obj.has_r?
+            return false unless has_s? ? (obj.has_s? && self.s == obj.s) : !obj.has_s?
+            true
+        end
+
+        def hash
+            hash_code = 0
+            hash_code ^= self.r.hash if has_r?
+            hash_code ^= self.s.hash if has_s?
+            hash_code
+        end
+
+        define_method(:dup, ::Kernel.instance_method(:dup))
+
+        def self.valid?(message, raise_exception = false)
+            return true if message.has_r?
+            super
+        end
+    end
+
+    class Holder < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.Holder"
+
+        repeated :int32, :numbers, 1
+        repeated ::GeneratedMethods::Leaf, :leaves, 2
+        optional ::GeneratedMethods::Leaf, :leaf, 3
+        required :int32, :id, 4
+        required ::GeneratedMethods::Req, :req, 5
+        optional ::GeneratedMethods::Kind, :kind, 6
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless self.numbers == obj.numbers
+            return false unless self.leaves == obj.leaves
+            return false unless has_leaf? ? (obj.has_leaf? && self.leaf == obj.leaf) : !obj.has_leaf?
+            return false unless has_id? ? (obj.has_id? && self.id == obj.id) : !obj.has_id?
+            return false unless has_req? ? (obj.has_req? && self.req == obj.req) : !obj.has_req?
+            return false unless has_kind? ? (obj.has_kind? && self.kind == obj.kind) : !obj.has_kind?
+            true
+        end
+
+        def hash
+            hash_code = 0
+            hash_code ^= self.numbers.hash
+            hash_code ^= self.leaves.hash
+            hash_code ^= self.leaf.hash if has_leaf?
+            hash_code ^= self.id.hash if has_id?
+            hash_code ^= self.req.hash if has_req?
+            hash_code ^= self.kind.hash if has_kind?
+            hash_code
+        end
+
+        define_method(:dup, ::Kernel.instance_method(:dup))
+
+        def initialize_copy(source)
+            super
+            @numbers = @numbers.dup if @numbers
+            @leaves = @leaves.dup.collect! { |value| value.dup } if @leaves
+            if @set_fields[3]
+                @leaf = @leaf.dup
+            else
+                @set_fields[3] = nil
+            end
+            if @set_fields[5]
+                @req = @req.dup
+            else
+                @set_fields[5] = nil
+            end
+        end
+
+        def self.valid?(message, raise_exception = false)
+            return true if message.has_id? && message.has_req? && message.req.valid?
+            super
+        end
+    end
+
+    class NoRequired < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.NoRequired"
+
+        optional ::GeneratedMethods::Leaf, :leaf, 1
+        repeated ::GeneratedMethods::Leaf, :leaves, 2
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless has_leaf? ? (obj.has_leaf? && self.leaf == obj.leaf) : !obj.has_leaf?
+            return false unless self.leaves == obj.leaves
+            true
+        end
+
+        def hash
+            hash_code = 0
+            hash_code ^= self.leaf.hash if has_leaf?
+            hash_code ^= self.leaves.hash
+            hash_code
+        end
+
+        define_method(:dup, ::Kernel.instance_method(:dup))
+
+        def initialize_copy(source)
+            super
+            if @set_fields[1]
+                @leaf = @leaf.dup
+            else
+                @set_fields[1] = nil
+            end
+            @leaves = @leaves.dup.collect! { |value| value.dup } if @leaves
+        end
+    end
+
+    class HashField < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.HashField"
+
+        optional :string, :hash, 1
+        optional :int32, :other, 2
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless has_hash? ? (obj.has_hash? && self.hash == obj.hash) : !obj.has_hash?
+            return false unless has_other? ? (obj.has_other? && self.other == obj.other) : !obj.has_other?
+            true
+        end
+
+        define_method(:dup, ::Kernel.instance_method(:dup))
+    end
+
+    class DupField < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.DupField"
+
+        optional :string, :dup, 1
+        repeated ::GeneratedMethods::Leaf, :leaves, 2
+
+        def ==(obj)
+            return false unless obj.is_a?(self.class)
+            return false unless has_dup? ? (obj.has_dup? && self.dup == obj.dup) : !obj.has_dup?
+            return false unless self.leaves == obj.leaves
+            true
+        end
+
+        def hash
+            hash_code = 0
+            hash_code ^= self.dup.hash if has_dup?
+            hash_code ^= self.leaves.hash
+            hash_code
+        end
+    end
+
+    class PrivateField < ::ProtocolBuffers::Message
+        set_fully_qualified_name "generated_methods.PrivateField"
+
+        optional :string, :initialize_copy, 1
+        optional :int32, :other, 2
+    end
+
+end